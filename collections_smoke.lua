@@ -0,0 +1,119 @@
+-- Smoke test for the native collections (IntArray, FloatArray, PlayerData).
+-- Drop it into ./mainscripts instead of your gamemode: the top-level checks run on load,
+-- the PlayerData reset check runs once a player connects, disconnects and reconnects.
+
+local function expectError(pattern, fn, ...)
+    local ok, err = pcall(fn, ...)
+    assert(not ok, "expected an error matching '" .. pattern .. "'")
+    assert(tostring(err):find(pattern, 1, true), "unexpected error: " .. tostring(err))
+end
+
+-- IntArray: bounds, table-style indexing, ipairs
+local ints = IntArray.new(4, 7)
+assert(#ints == 4 and ints:size() == 4)
+assert(ints[1] == 7 and ints:get(4) == 7)
+assert(ints[0] == nil and ints[5] == nil and ints[1.5] == nil)
+ints[2] = 3
+ints:set(3, -1)
+assert(ints[2.0] == 3 and math.type(ints[3]) == "integer")
+expectError("index out of range", function() return ints:get(5) end)
+expectError("index out of range", function() ints[0] = 1 end)
+expectError("number has no integer representation", function() ints:set(1, 1.5) end)
+
+local count = 0
+for i, v in ipairs(ints) do
+    count = count + 1
+    assert(v == ints:get(i))
+end
+assert(count == 4)
+
+-- find with a start position
+ints:fill(0)
+ints[2], ints[4] = 9, 9
+assert(ints:find(9) == 2)
+assert(ints:find(9, 3) == 4)
+assert(ints:find(9, 5) == nil)
+assert(ints:find(1) == nil)
+expectError("index out of range", function() return ints:find(9, 0) end)
+
+-- integer sum wraps around like Lua integer arithmetic
+local wrap = IntArray.new(2, math.maxinteger)
+assert(wrap:sum() == math.maxinteger + math.maxinteger)
+assert(IntArray.new(0):sum() == 0)
+expectError("invalid array size", IntArray.new, -1)
+
+-- FloatArray
+local floats = FloatArray.new(3)
+assert(floats[1] == 0.0 and math.type(floats[1]) == "float")
+floats:fill(0.5)
+floats[3] = 2
+assert(floats:sum() == 3.0)
+assert(floats:find(2.0) == 3)
+
+-- PlayerData: columns, kernels, errors
+local stats = PlayerData.new({ kills = "int", ratio = "float", admin = "bool", tag = "string" })
+local kills = stats.kills
+assert(#kills > 0 and kills:size() == #kills)
+assert(kills[0] == 0 and stats.ratio[0] == 0.0 and stats.admin[0] == false and stats.tag[0] == "")
+assert(kills[-1] == nil and kills[#kills] == nil)
+kills[0], kills[5] = 2, 3
+assert(kills:sum() == 5)
+assert(kills:find(3) == 5 and kills:find(2, 1) == nil)
+stats.admin[5] = true
+assert(stats.admin:find(true) == 5)
+stats.tag:fill("none")
+assert(stats.tag[7] == "none")
+expectError("boolean expected", function() stats.admin[1] = 1 end)
+expectError("index out of range", function() kills[#kills] = 1 end)
+
+stats:reset(5)
+assert(kills[5] == 0 and stats.admin[5] == false and stats.tag[5] == "" and kills[0] == 2)
+stats:clear()
+assert(kills:sum() == 0 and stats.tag[7] == "")
+
+expectError("PlayerData has no field 'deaths'", function() return stats.deaths end)
+expectError("PlayerData field 'hp' has invalid type 'integer'", PlayerData.new, { hp = "integer" })
+expectError("PlayerData field 'hp' has invalid type 'number'", PlayerData.new, { hp = 100 })
+expectError("PlayerData field name 'reset' is reserved", PlayerData.new, { reset = "int" })
+expectError("PlayerData field names must be strings", PlayerData.new, { "int" })
+
+-- A finalizer running after a PlayerData was collected must get an error, not freed memory.
+local afterCollect
+do
+    local victim, column
+    -- Finalizers run in reverse order of marking, so this one runs after the victim's.
+    setmetatable({}, {
+        __gc = function()
+            afterCollect = {
+                select(2, pcall(function() victim:clear() end)),
+                select(2, pcall(function() return column[0] end)),
+            }
+        end
+    })
+    victim = PlayerData.new({ x = "int" })
+    column = victim.x
+end
+collectgarbage()
+collectgarbage()
+assert(afterCollect, "finalizer did not run")
+assert(tostring(afterCollect[1]):find("collected PlayerData", 1, true))
+assert(tostring(afterCollect[2]):find("collected PlayerData", 1, true))
+
+-- PlayerData reset on disconnect
+local session = PlayerData.new({ visits = "int", name = "string" })
+
+function OnIncomingConnection(playerid, ip_address, port)
+    assert(session.visits[playerid] == 0 and session.name[playerid] == "", "slots were not reset on disconnect")
+end
+
+function OnPlayerConnect(playerid)
+    session.visits[playerid] = session.visits[playerid] + 1
+    session.name[playerid] = "player" .. playerid
+end
+
+function OnPlayerDisconnect(playerid, reason)
+    assert(session.visits[playerid] == 1, "slots were cleared before OnPlayerDisconnect")
+    printOMP("collections smoke: disconnect of", session.name[playerid], "ok")
+end
+
+print("collections smoke: top-level checks passed")
@@ -6,6 +6,11 @@
 #include <map>
 #include <iostream>
 #include <typeinfo>
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <cstring>
 #ifndef _MSC_VER
 #include <cxxabi.h>
 #include <stdlib.h>
@@ -275,6 +280,546 @@ private:
         return 0;
     }
 
+    // Contiguous storage shared by IntArray/FloatArray and the PlayerData columns. The kernels
+    // below work on a pointer/size view, so both kinds of container use the same loops.
+    template <typename T>
+    struct ElementView
+    {
+        T *data;
+        lua_Integer size;
+        // Lua-side index of data[0]: 1 for arrays, 0 for player IDs.
+        lua_Integer base;
+    };
+
+    // Booleans take one byte each so columns stay contiguous, unlike std::vector<bool>.
+    using LuaBool = unsigned char;
+
+    template <typename T>
+    static T checkValue(lua_State *L, int index)
+    {
+        if constexpr (std::is_same_v<T, lua_Integer>)
+        {
+            return luaL_checkinteger(L, index);
+        }
+        else if constexpr (std::is_same_v<T, lua_Number>)
+        {
+            return luaL_checknumber(L, index);
+        }
+        else if constexpr (std::is_same_v<T, LuaBool>)
+        {
+            luaL_checktype(L, index, LUA_TBOOLEAN);
+            return LuaBool(lua_toboolean(L, index));
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            size_t length;
+            const char *value = luaL_checklstring(L, index, &length);
+            return std::string(value, length);
+        }
+    }
+
+    template <typename T>
+    static void pushValue(lua_State *L, const T &value)
+    {
+        if constexpr (std::is_same_v<T, lua_Integer>)
+        {
+            lua_pushinteger(L, value);
+        }
+        else if constexpr (std::is_same_v<T, lua_Number>)
+        {
+            lua_pushnumber(L, value);
+        }
+        else if constexpr (std::is_same_v<T, LuaBool>)
+        {
+            lua_pushboolean(L, value);
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            lua_pushlstring(L, value.data(), value.size());
+        }
+    }
+
+    template <typename T>
+    static lua_Integer checkViewIndex(lua_State *L, const ElementView<T> &view, int index)
+    {
+        lua_Integer i = luaL_checkinteger(L, index);
+        luaL_argcheck(L, i >= view.base && i - view.base < view.size, index, "index out of range");
+        return i - view.base;
+    }
+
+    // view:get(i)
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewGet(lua_State *L)
+    {
+        auto view = Check(L, 1);
+        pushValue<T>(L, view.data[checkViewIndex(L, view, 2)]);
+        return 1;
+    }
+
+    // view:set(i, value), view[i] = value
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewSet(lua_State *L)
+    {
+        auto view = Check(L, 1);
+        lua_Integer i = checkViewIndex(L, view, 2);
+        view.data[i] = checkValue<T>(L, 3);
+        return 0;
+    }
+
+    // view:size(), #view
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewSize(lua_State *L)
+    {
+        lua_pushinteger(L, Check(L, 1).size);
+        return 1;
+    }
+
+    // view:fill(value)
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewFill(lua_State *L)
+    {
+        auto view = Check(L, 1);
+        std::fill_n(view.data, view.size, checkValue<T>(L, 2));
+        return 0;
+    }
+
+    // view:sum()
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewSum(lua_State *L)
+    {
+        auto view = Check(L, 1);
+        if constexpr (std::is_same_v<T, lua_Integer>)
+        {
+            // Wrap around on overflow the same way Lua integer arithmetic does.
+            lua_Unsigned sum = 0;
+            for (lua_Integer i = 0; i < view.size; ++i)
+            {
+                sum += static_cast<lua_Unsigned>(view.data[i]);
+            }
+            lua_pushinteger(L, static_cast<lua_Integer>(sum));
+        }
+        else
+        {
+            lua_Number sum = 0;
+            for (lua_Integer i = 0; i < view.size; ++i)
+            {
+                sum += view.data[i];
+            }
+            lua_pushnumber(L, sum);
+        }
+        return 1;
+    }
+
+    // view:find(value [, init]) - returns the index of the first match at or after init, or nil.
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewFind(lua_State *L)
+    {
+        auto view = Check(L, 1);
+        lua_Integer init = luaL_optinteger(L, 3, view.base);
+        luaL_argcheck(L, init >= view.base, 3, "index out of range");
+        T value = checkValue<T>(L, 2);
+
+        if (init - view.base < view.size)
+        {
+            T *end = view.data + view.size;
+            T *found = std::find(view.data + (init - view.base), end, value);
+            if (found != end)
+            {
+                lua_pushinteger(L, (found - view.data) + view.base);
+                return 1;
+            }
+        }
+        lua_pushnil(L);
+        return 1;
+    }
+
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    static int native_viewIndex(lua_State *L)
+    {
+        // Behave like a table for numeric keys: anything out of range reads as nil so that
+        // ipairs() and `arr[#arr + 1]` work. The explicit :get() stays strict.
+        if (lua_type(L, 2) == LUA_TNUMBER)
+        {
+            auto view = Check(L, 1);
+            int isInteger;
+            lua_Integer i = lua_tointegerx(L, 2, &isInteger);
+            if (isInteger && i >= view.base && i - view.base < view.size)
+            {
+                pushValue<T>(L, view.data[i - view.base]);
+            }
+            else
+            {
+                lua_pushnil(L);
+            }
+            return 1;
+        }
+        lua_pushvalue(L, 2);
+        lua_gettable(L, lua_upvalueindex(1));
+        return 1;
+    }
+
+    template <typename T, ElementView<T> (*Check)(lua_State *, int)>
+    void registerView(lua_State *L, const char *typeName)
+    {
+        static const luaL_Reg methods[] = {
+            {"get", native_viewGet<T, Check>},
+            {"set", native_viewSet<T, Check>},
+            {"size", native_viewSize<T, Check>},
+            {"fill", native_viewFill<T, Check>},
+            {"find", native_viewFind<T, Check>},
+            {nullptr, nullptr}};
+
+        luaL_newmetatable(L, typeName);
+        lua_newtable(L);
+        luaL_setfuncs(L, methods, 0);
+        if constexpr (std::is_same_v<T, lua_Integer> || std::is_same_v<T, lua_Number>)
+        {
+            lua_pushcfunction(L, (native_viewSum<T, Check>));
+            lua_setfield(L, -2, "sum");
+        }
+        lua_pushcclosure(L, (native_viewIndex<T, Check>), 1);
+        lua_setfield(L, -2, "__index");
+        lua_pushcfunction(L, (native_viewSet<T, Check>));
+        lua_setfield(L, -2, "__newindex");
+        lua_pushcfunction(L, (native_viewSize<T, Check>));
+        lua_setfield(L, -2, "__len");
+        lua_pop(L, 1);
+    }
+
+    // IntArray/FloatArray keep their elements inline right after the header inside a single
+    // Lua userdata block, so there is no per-element boxing and nothing for the GC to traverse.
+    struct NumericArrayHeader
+    {
+        lua_Integer size;
+    };
+
+    template <typename T>
+    static const char *numericArrayType()
+    {
+        if constexpr (std::is_same_v<T, lua_Integer>)
+        {
+            return "OmpLua.IntArray";
+        }
+        else
+        {
+            return "OmpLua.FloatArray";
+        }
+    }
+
+    template <typename T>
+    static ElementView<T> checkNumericArray(lua_State *L, int index)
+    {
+        auto *header = static_cast<NumericArrayHeader *>(luaL_checkudata(L, index, numericArrayType<T>()));
+        return {reinterpret_cast<T *>(header + 1), header->size, 1};
+    }
+
+    // IntArray.new(size [, value]) / FloatArray.new(size [, value])
+    template <typename T>
+    static int native_arrayNew(lua_State *L)
+    {
+        lua_Integer size = luaL_checkinteger(L, 1);
+        luaL_argcheck(L, size >= 0 && static_cast<lua_Unsigned>(size) <= (std::numeric_limits<size_t>::max() - sizeof(NumericArrayHeader)) / sizeof(T), 1, "invalid array size");
+        T value = lua_isnoneornil(L, 2) ? T(0) : checkValue<T>(L, 2);
+
+        auto *header = static_cast<NumericArrayHeader *>(lua_newuserdatauv(L, sizeof(NumericArrayHeader) + size_t(size) * sizeof(T), 0));
+        header->size = size;
+        std::fill_n(reinterpret_cast<T *>(header + 1), size, value);
+        luaL_setmetatable(L, numericArrayType<T>());
+        return 1;
+    }
+
+    template <typename T>
+    void registerNumericArray(lua_State *L, const char *global)
+    {
+        registerView<T, checkNumericArray<T>>(L, numericArrayType<T>());
+
+        lua_newtable(L);
+        lua_pushcfunction(L, native_arrayNew<T>);
+        lua_setfield(L, -2, "new");
+        lua_setglobal(L, global);
+    }
+
+    // Per-player data slots declared from a Lua schema. Every field is a contiguous column indexed
+    // by player ID, and all columns of a player are reset when that player disconnects.
+    using PlayerDataValues = std::variant<std::vector<lua_Integer>, std::vector<lua_Number>, std::vector<LuaBool>, std::vector<std::string>>;
+
+    struct PlayerDataSlots
+    {
+        std::vector<PlayerDataValues> columns;
+
+        void reset(int playerid)
+        {
+            for (auto &column : columns)
+            {
+                std::visit([playerid](auto &values)
+                           {
+                    using T = typename std::decay_t<decltype(values)>::value_type;
+                    values[playerid] = T(); },
+                           column);
+            }
+        }
+
+        void clear()
+        {
+            for (auto &column : columns)
+            {
+                std::visit([](auto &values)
+                           {
+                    using T = typename std::decay_t<decltype(values)>::value_type;
+                    std::fill(values.begin(), values.end(), T()); },
+                           column);
+            }
+        }
+    };
+
+    // Contents of a PlayerData userdata. `slots` is nulled by __gc, so anything that still reaches
+    // the object afterwards (e.g. another finalizer in the same cycle) gets a Lua error instead.
+    struct PlayerDataHandle
+    {
+        PlayerDataSlots *slots;
+    };
+
+    // Contents of a column userdata. Its user value is the owning PlayerData, which keeps `owner`
+    // alive for as long as the column is reachable.
+    template <typename T>
+    struct PlayerDataColumn
+    {
+        PlayerDataHandle *owner;
+        T *data;
+    };
+
+    // Slots currently alive in the Lua state, cleared from onPlayerDisconnect.
+    std::vector<PlayerDataSlots *> playerDataSlots_;
+
+    static constexpr const char *PlayerDataType = "OmpLua.PlayerData";
+
+    template <typename T>
+    static const char *playerDataColumnType()
+    {
+        if constexpr (std::is_same_v<T, lua_Integer>)
+        {
+            return "OmpLua.PlayerData.IntColumn";
+        }
+        else if constexpr (std::is_same_v<T, lua_Number>)
+        {
+            return "OmpLua.PlayerData.FloatColumn";
+        }
+        else if constexpr (std::is_same_v<T, LuaBool>)
+        {
+            return "OmpLua.PlayerData.BoolColumn";
+        }
+        else
+        {
+            return "OmpLua.PlayerData.StringColumn";
+        }
+    }
+
+    // Returns the index of the type in PlayerDataValues, or -1 for an unknown type name.
+    static int findPlayerDataFieldType(const char *name)
+    {
+        static const char *const types[] = {"int", "float", "bool", "string"};
+        for (int i = 0; i < int(std::size(types)); ++i)
+        {
+            if (std::strcmp(name, types[i]) == 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static bool isPlayerDataMethod(const char *name)
+    {
+        return std::strcmp(name, "reset") == 0 || std::strcmp(name, "clear") == 0;
+    }
+
+    static PlayerDataSlots *checkPlayerData(lua_State *L, int index)
+    {
+        auto *handle = static_cast<PlayerDataHandle *>(luaL_checkudata(L, index, PlayerDataType));
+        if (handle->slots == nullptr)
+        {
+            luaL_error(L, "attempt to use a collected PlayerData");
+        }
+        return handle->slots;
+    }
+
+    template <typename T>
+    static ElementView<T> checkPlayerDataColumn(lua_State *L, int index)
+    {
+        auto *column = static_cast<PlayerDataColumn<T> *>(luaL_checkudata(L, index, playerDataColumnType<T>()));
+        if (column->owner->slots == nullptr)
+        {
+            luaL_error(L, "attempt to use a column of a collected PlayerData");
+        }
+        return {column->data, PLAYER_POOL_SIZE, 0};
+    }
+
+    static int checkPlayerId(lua_State *L, int index)
+    {
+        lua_Integer playerid = luaL_checkinteger(L, index);
+        luaL_argcheck(L, playerid >= 0 && playerid < PLAYER_POOL_SIZE, index, "invalid player id");
+        return static_cast<int>(playerid);
+    }
+
+    // Adds a column to the PlayerData at `owner` and pushes its handle.
+    template <typename T>
+    static void pushPlayerDataColumn(lua_State *L, PlayerDataHandle *handle, int owner)
+    {
+        auto &values = std::get<std::vector<T>>(handle->slots->columns.emplace_back(std::in_place_type<std::vector<T>>, PLAYER_POOL_SIZE));
+
+        auto *column = static_cast<PlayerDataColumn<T> *>(lua_newuserdatauv(L, sizeof(PlayerDataColumn<T>), 1));
+        column->owner = handle;
+        column->data = values.data();
+        luaL_setmetatable(L, playerDataColumnType<T>());
+        lua_pushvalue(L, owner);
+        lua_setiuservalue(L, -2, 1);
+    }
+
+    // PlayerData.new({ field = "int" | "float" | "bool" | "string", ... })
+    int native_playerDataNew(lua_State *L)
+    {
+        luaL_checktype(L, 1, LUA_TTABLE);
+
+        // Validate the whole schema before any C++ state is created so a Lua error can't leak it.
+        lua_pushnil(L);
+        while (lua_next(L, 1) != 0)
+        {
+            if (lua_type(L, -2) != LUA_TSTRING)
+            {
+                return luaL_error(L, "PlayerData field names must be strings, got %s", luaL_typename(L, -2));
+            }
+            const char *name = lua_tostring(L, -2);
+            if (lua_type(L, -1) != LUA_TSTRING || findPlayerDataFieldType(lua_tostring(L, -1)) < 0)
+            {
+                return luaL_error(L, "PlayerData field '%s' has invalid type '%s' (expected \"int\", \"float\", \"bool\" or \"string\")",
+                                  name, lua_type(L, -1) == LUA_TSTRING ? lua_tostring(L, -1) : luaL_typename(L, -1));
+            }
+            if (isPlayerDataMethod(name))
+            {
+                return luaL_error(L, "PlayerData field name '%s' is reserved", name);
+            }
+            lua_pop(L, 1);
+        }
+
+        auto *handle = static_cast<PlayerDataHandle *>(lua_newuserdatauv(L, sizeof(PlayerDataHandle), 1));
+        handle->slots = nullptr;
+        luaL_setmetatable(L, PlayerDataType);
+        handle->slots = new PlayerDataSlots();
+        playerDataSlots_.push_back(handle->slots);
+        int self = lua_gettop(L);
+
+        // Column handles are created once and cached by name in the user value, so `data.field`
+        // is a single raw table lookup.
+        lua_newtable(L);
+        int columns = lua_gettop(L);
+        lua_pushnil(L);
+        while (lua_next(L, 1) != 0)
+        {
+            switch (findPlayerDataFieldType(lua_tostring(L, -1)))
+            {
+            case 0:
+                pushPlayerDataColumn<lua_Integer>(L, handle, self);
+                break;
+            case 1:
+                pushPlayerDataColumn<lua_Number>(L, handle, self);
+                break;
+            case 2:
+                pushPlayerDataColumn<LuaBool>(L, handle, self);
+                break;
+            case 3:
+                pushPlayerDataColumn<std::string>(L, handle, self);
+                break;
+            }
+            lua_setfield(L, columns, lua_tostring(L, -3));
+            lua_pop(L, 1);
+        }
+        lua_setiuservalue(L, self, 1);
+        return 1;
+    }
+
+    // data.field - returns the column handle; methods are looked up after the columns.
+    static int native_playerDataIndex(lua_State *L)
+    {
+        checkPlayerData(L, 1);
+        lua_getiuservalue(L, 1, 1);
+        lua_pushvalue(L, 2);
+        if (lua_rawget(L, -2) != LUA_TNIL)
+        {
+            return 1;
+        }
+        lua_pushvalue(L, 2);
+        if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TNIL)
+        {
+            return 1;
+        }
+        return luaL_error(L, "PlayerData has no field '%s'", luaL_tolstring(L, 2, nullptr));
+    }
+
+    // data:reset(playerid)
+    static int native_playerDataReset(lua_State *L)
+    {
+        PlayerDataSlots *slots = checkPlayerData(L, 1);
+        slots->reset(checkPlayerId(L, 2));
+        return 0;
+    }
+
+    // data:clear()
+    static int native_playerDataClear(lua_State *L)
+    {
+        checkPlayerData(L, 1)->clear();
+        return 0;
+    }
+
+    int native_playerDataGc(lua_State *L)
+    {
+        auto *handle = static_cast<PlayerDataHandle *>(luaL_checkudata(L, 1, PlayerDataType));
+        if (handle->slots != nullptr)
+        {
+            playerDataSlots_.erase(std::remove(playerDataSlots_.begin(), playerDataSlots_.end(), handle->slots), playerDataSlots_.end());
+            delete handle->slots;
+            handle->slots = nullptr;
+        }
+        return 0;
+    }
+
+    template <int (OmpLua::*Native)(lua_State *)>
+    void pushNative(lua_State *L)
+    {
+        lua_pushlightuserdata(L, this);
+        lua_pushcclosure(L, [](lua_State *L) -> int
+                         {
+            OmpLua *self = static_cast<OmpLua*>(lua_touserdata(L, lua_upvalueindex(1)));
+            return (self->*Native)(L); }, 1);
+    }
+
+    void registerCollections(lua_State *L)
+    {
+        registerNumericArray<lua_Integer>(L, "IntArray");
+        registerNumericArray<lua_Number>(L, "FloatArray");
+
+        registerView<lua_Integer, checkPlayerDataColumn<lua_Integer>>(L, playerDataColumnType<lua_Integer>());
+        registerView<lua_Number, checkPlayerDataColumn<lua_Number>>(L, playerDataColumnType<lua_Number>());
+        registerView<LuaBool, checkPlayerDataColumn<LuaBool>>(L, playerDataColumnType<LuaBool>());
+        registerView<std::string, checkPlayerDataColumn<std::string>>(L, playerDataColumnType<std::string>());
+
+        luaL_newmetatable(L, PlayerDataType);
+        lua_newtable(L);
+        lua_pushcfunction(L, native_playerDataReset);
+        lua_setfield(L, -2, "reset");
+        lua_pushcfunction(L, native_playerDataClear);
+        lua_setfield(L, -2, "clear");
+        lua_pushcclosure(L, native_playerDataIndex, 1);
+        lua_setfield(L, -2, "__index");
+        pushNative<&OmpLua::native_playerDataGc>(L);
+        lua_setfield(L, -2, "__gc");
+        lua_pop(L, 1);
+
+        lua_newtable(L);
+        pushNative<&OmpLua::native_playerDataNew>(L);
+        lua_setfield(L, -2, "new");
+        lua_setglobal(L, "PlayerData");
+    }
+
 public:
     // Visit https://open.mp/uid to generate a new unique ID.
     PROVIDE_UID(0x46EEFEA7E0B81CAE);
@@ -316,6 +861,10 @@ public:
         // public OnPlayerDisconnect(playerid, reason)
         callLua("OnPlayerDisconnect", player.getID(), int(reason));
         playerMap_.erase(player.getID());
+        for (PlayerDataSlots *slots : playerDataSlots_)
+        {
+            slots->reset(player.getID());
+        }
     }
     void onPlayerClientInit(IPlayer &player) override
     {
@@ -609,6 +1158,7 @@ public:
             core_->printLn("OMP LUA: Lua state for main script load error!");
         }
         luaL_openlibs(L_);
+        registerCollections(L_);
 
         mainscriptFile_ = scanMainscripts("./mainscripts");
 
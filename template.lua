@@ -1,3 +1,7 @@
+-- Per-player slots are reset automatically after OnPlayerDisconnect.
+local playerStats = PlayerData.new({ deaths = "int", lastText = "string" })
+local deaths = playerStats.deaths
+
 function OnIncomingConnection(playerid, ip_address, port)
     printOMP("Player incoming conntection:", playerid, ip_address, port)
 end
@@ -8,6 +12,7 @@ end
 
 function OnPlayerDisconnect(playerid, reason)
     printOMP("player disconnected: ", playerid, reason)
+    printOMP("deaths:", deaths[playerid], ", last message:", playerStats.lastText[playerid])
 end
 
 function onPlayerClientInit(playerid)
@@ -28,6 +33,7 @@ function OnPlayerStreamOut(playerid, forplayerid)
 end
 
 function OnPlayerText(playerid, text)
+    playerStats.lastText[playerid] = text
     printOMP("player", playerid, "sent message in chat:", text)
     return true
 end
@@ -54,6 +60,7 @@ function OnPlayerKeyStateChange(playerid, newkeys, oldkeys)
 end
 
 function OnPlayerDeath(playerid, killerid, reason)
+    deaths[playerid] = deaths[playerid] + 1
     printOMP("player", playerid, "killed by:", killerid, ", weapon/reason:", reason)
 end
 